@@ -608,6 +608,26 @@ static std::pair<Required, std::vector<Option>> create_pattern_tree(std::string
 	return { std::move(pattern), std::move(options) };
 }
 
+// Match the argv patterns against a fixed pattern tree. On success, 'ret' holds the parsed options
+// and 'argv_patterns' holds whatever was left unconsumed.
+static bool match_pattern(Required& pattern, PatternList& argv_patterns, docopt::Options& ret)
+{
+	std::vector<std::shared_ptr<LeafPattern>> collected;
+	if (!pattern.match(argv_patterns, collected))
+		return false;
+
+	// (a.name, a.value) for a in (pattern.flat() + collected)
+	for (auto* p : pattern.leaves()) {
+		ret[p->name()] = p->getValue();
+	}
+
+	for (auto const& p : collected) {
+		ret[p->name()] = p->getValue();
+	}
+
+	return true;
+}
+
 DOCOPT_INLINE
 docopt::Options
 docopt::docopt_parse(std::string const& doc,
@@ -633,20 +653,11 @@ docopt::docopt_parse(std::string const& doc,
 
 	extras(help, version, argv_patterns);
 
-	std::vector<std::shared_ptr<LeafPattern>> collected;
-	bool matched = pattern.fix().match(argv_patterns, collected);
-	if (matched && argv_patterns.empty()) {
-		docopt::Options ret;
-
-		// (a.name, a.value) for a in (pattern.flat() + collected)
-		for (auto* p : pattern.leaves()) {
-			ret[p->name()] = p->getValue();
-		}
-
-		for (auto const& p : collected) {
-			ret[p->name()] = p->getValue();
-		}
+	pattern.fix();
 
+	docopt::Options ret;
+	bool matched = match_pattern(pattern, argv_patterns, ret);
+	if (matched && argv_patterns.empty()) {
 		return ret;
 	}
 
@@ -685,3 +696,140 @@ docopt::docopt(std::string const& doc,
 		std::exit(-1);
 	} /* Any other exception is unexpected: let std::terminate grab it */
 }
+
+
+#if 0
+#pragma mark -
+#pragma mark GrammarSet
+#endif
+
+struct docopt::GrammarSet::Impl {
+	// A unique compiled pattern, and the grammars (by index) that compiled to it
+	struct Tree {
+		size_t table;
+		std::shared_ptr<Required> pattern;
+		std::vector<size_t> grammars;
+	};
+
+	std::vector<std::vector<Option>> tables;
+	std::vector<Tree> trees;
+	size_t count = 0;
+};
+
+static bool same_option_table(std::vector<Option> const& lhs, std::vector<Option> const& rhs)
+{
+	return lhs.size() == rhs.size()
+		&& std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](Option const& o1, Option const& o2) {
+			return o1.hash() == o2.hash();
+		});
+}
+
+// Matching writes counts and lists back into the argv leaves, so every grammar needs its own copy
+static PatternList clone_argv_patterns(PatternList const& argv_patterns)
+{
+	PatternList ret;
+	ret.reserve(argv_patterns.size());
+	for(auto const& p : argv_patterns) {
+		if (auto opt = dynamic_cast<Option const*>(p.get())) {
+			ret.emplace_back(std::make_shared<Option>(*opt));
+		} else {
+			ret.emplace_back(std::make_shared<Argument>(static_cast<Argument const&>(*p)));
+		}
+	}
+	return ret;
+}
+
+DOCOPT_INLINE
+docopt::GrammarSet::GrammarSet(std::vector<std::string> const& docs)
+: fImpl(new Impl)
+{
+	fImpl->count = docs.size();
+
+	// shared across all grammars, so that identical subtrees are only kept once
+	UniquePatternSet patterns;
+
+	for(size_t i = 0; i < docs.size(); ++i) {
+		Required pattern;
+		std::vector<Option> options;
+		try {
+			std::tie(pattern, options) = create_pattern_tree(docs[i]);
+		} catch (Tokens::OptionError const& error) {
+			throw DocoptLanguageError(error.what());
+		}
+
+		// argv is tokenized once per distinct option table
+		auto table = std::find_if(fImpl->tables.begin(), fImpl->tables.end(), [&](std::vector<Option> const& t) {
+			return same_option_table(t, options);
+		});
+		size_t tableIndex = static_cast<size_t>(std::distance(fImpl->tables.begin(), table));
+		if (table == fImpl->tables.end()) {
+			fImpl->tables.emplace_back(std::move(options));
+		}
+
+		// Each tree is fixed on its own first, since repeated arguments depend on the whole grammar;
+		// only then is it safe to share its (now final) subtrees with the other grammars.
+		auto root = std::make_shared<Required>(std::move(pattern));
+		root->fix();
+		root->fix_identities(patterns);
+
+		auto tree = std::find_if(fImpl->trees.begin(), fImpl->trees.end(), [&](Impl::Tree const& t) {
+			return t.table == tableIndex && t.pattern->hash() == root->hash();
+		});
+		if (tree == fImpl->trees.end()) {
+			fImpl->trees.push_back({ tableIndex, std::move(root), { i } });
+		} else {
+			tree->grammars.push_back(i);
+		}
+	}
+}
+
+DOCOPT_INLINE docopt::GrammarSet::GrammarSet(GrammarSet&&) noexcept = default;
+DOCOPT_INLINE docopt::GrammarSet& docopt::GrammarSet::operator=(GrammarSet&&) noexcept = default;
+DOCOPT_INLINE docopt::GrammarSet::~GrammarSet() = default;
+
+DOCOPT_INLINE
+size_t docopt::GrammarSet::size() const
+{
+	// a moved-from set behaves as an empty one
+	if (!fImpl)
+		return 0;
+	return fImpl->count;
+}
+
+DOCOPT_INLINE
+std::map<size_t, docopt::Options>
+docopt::GrammarSet::match(std::vector<std::string> const& argv, bool options_first) const
+{
+	if (!fImpl)
+		return {};
+
+	std::vector<PatternList> tokenized(fImpl->tables.size());
+	std::vector<bool> valid(fImpl->tables.size(), false);
+	for(size_t i = 0; i < fImpl->tables.size(); ++i) {
+		// parse_argv adds unknown options to the table, so work on a copy
+		std::vector<Option> options = fImpl->tables[i];
+		try {
+			tokenized[i] = parse_argv(Tokens(argv), options, options_first);
+			valid[i] = true;
+		} catch (Tokens::OptionError const&) {
+			// argv is malformed for this option table: none of its grammars accept it
+		}
+	}
+
+	std::map<size_t, Options> ret;
+	for(auto const& tree : fImpl->trees) {
+		if (!valid[tree.table])
+			continue;
+
+		PatternList argv_patterns = clone_argv_patterns(tokenized[tree.table]);
+		Options options;
+		if (!match_pattern(*tree.pattern, argv_patterns, options) || !argv_patterns.empty())
+			continue;
+
+		for(size_t grammar : tree.grammars) {
+			ret[grammar] = options;
+		}
+	}
+
+	return ret;
+}
@@ -37,6 +37,7 @@
 #include "docopt_value.h"
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -89,6 +90,46 @@ namespace docopt {
 					    bool help = true,
 					    std::string const& version = {},
 					    bool options_first = false) noexcept;
+
+	/// A set of usage strings compiled once, so that one argv can be matched against all of them
+	///
+	/// Grammars with identical option tables share a single tokenization of argv, and grammars
+	/// whose patterns are identical are only matched once. Identical subtrees are also shared
+	/// between the compiled patterns, but that only saves memory: every distinct pattern is still
+	/// walked on its own, since what a subtree matches depends on what the rest of its pattern
+	/// has already consumed from argv.
+	///
+	/// A moved-from set behaves as an empty one.
+	class DOCOPT_API GrammarSet {
+	public:
+		/// @param docs  The usage strings, one per grammar
+		///
+		/// @throws DocoptLanguageError if any of the doc usage strings had errors itself
+		explicit GrammarSet(std::vector<std::string> const& docs);
+		GrammarSet(GrammarSet&&) noexcept;
+		GrammarSet& operator=(GrammarSet&&) noexcept;
+		~GrammarSet();
+
+		/// The number of grammars in the set
+		size_t size() const;
+
+		/// Match the user-supplied arguments against every grammar in the set.
+		///
+		/// Unlike 'docopt_parse', '--help' and '--version' are not treated specially, and a
+		/// grammar that rejects argv is simply left out of the result.
+		///
+		/// @param argv  The user-supplied arguments
+		/// @param options_first  Whether options must precede all args (true), or if args and options
+		///                can be arbitrarily mixed.
+		///
+		/// @returns the parsed options for each accepting grammar, keyed by its index in 'docs'
+		std::map<size_t, Options> match(std::vector<std::string> const& argv,
+						bool options_first = false) const;
+
+	private:
+		struct Impl;
+		std::unique_ptr<Impl> fImpl;
+	};
 }
 
 #ifdef DOCOPT_HEADER_ONLY
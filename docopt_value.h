@@ -243,28 +243,33 @@ namespace docopt {
 	inline
 	size_t value::hash() const noexcept
 	{
+		// mix in the kind, so that eg an empty list, 'false' and '0' do not all hash alike
+		size_t seed = std::hash<int>()(static_cast<int>(kind_));
 		switch (kind_) {
 			case Kind::String:
-				return std::hash<std::string>()(variant_.strValue);
+				hash_combine(seed, variant_.strValue);
+				break;
 
-			case Kind::StringList: {
-				size_t seed = std::hash<size_t>()(variant_.strList.size());
+			case Kind::StringList:
+				hash_combine(seed, variant_.strList.size());
 				for(auto const& str : variant_.strList) {
 					hash_combine(seed, str);
 				}
-				return seed;
-			}
+				break;
 
 			case Kind::Bool:
-				return std::hash<bool>()(variant_.boolValue);
+				hash_combine(seed, variant_.boolValue);
+				break;
 
 			case Kind::Long:
-				return std::hash<long>()(variant_.longValue);
+				hash_combine(seed, variant_.longValue);
+				break;
 
 			case Kind::Empty:
 			default:
-				return std::hash<void*>()(nullptr);
+				break;
 		}
+		return seed;
 	}
 
 	inline
@@ -0,0 +1,199 @@
+//
+//  run_grammarset.cpp
+//  docopt
+//
+//  Checks that docopt::GrammarSet agrees with docopt_parse on every usage string and argv
+//  in the testcases file, compiled together into one set.
+//
+
+#include "docopt.h"
+#include "docopt_util.h"
+#include "docopt_private.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+	struct Testcase {
+		std::string doc;
+		std::vector<std::vector<std::string>> argvs;
+	};
+
+	int failures = 0;
+
+	void fail(std::string const& message)
+	{
+		++failures;
+		std::cout << "FAIL: " << message << std::endl;
+	}
+
+	std::string show(std::vector<std::string> const& argv)
+	{
+		return "[" + join(argv.begin(), argv.end(), " ") + "]";
+	}
+
+	// Same format as run_tests.py: only the docs and argvs are used, the expected JSON is not.
+	std::vector<Testcase> parse_testcases(std::string raw)
+	{
+		// drop '#' comments up to the end of their line
+		for(auto hash = raw.find('#'); hash != std::string::npos; hash = raw.find('#', hash)) {
+			raw.erase(hash, raw.find('\n', hash) - hash);
+		}
+		raw = trim(std::move(raw));
+		if (starts_with(raw, "\"\"\""))
+			raw.erase(0, 3);
+
+		std::vector<Testcase> ret;
+		for(auto const& fixture : regex_split(raw, std::regex{"r\"\"\""})) {
+			auto end_of_doc = fixture.find("\"\"\"");
+			if (end_of_doc == std::string::npos)
+				continue;
+
+			Testcase testcase;
+			testcase.doc = fixture.substr(0, end_of_doc);
+
+			auto cases = regex_split(fixture.substr(end_of_doc + 3), std::regex{"\\$"});
+			for(size_t i = 1; i < cases.size(); ++i) {
+				std::string line = trim(std::move(cases[i]));
+				line = line.substr(0, line.find('\n'));
+
+				// prog, _, argv = line.partition(' ')
+				std::string prog, args;
+				std::tie(prog, std::ignore, args) = partition(std::move(line), " ");
+				if (prog.empty())
+					continue;
+				testcase.argvs.push_back(split(args));
+			}
+
+			if (!testcase.argvs.empty())
+				ret.push_back(std::move(testcase));
+		}
+		return ret;
+	}
+
+	// Every argv is checked against its own doc with docopt_parse, and against every doc with a
+	// set holding that doc alone, so sharing between grammars cannot change any result.
+	void check_against_docopt_parse(std::vector<Testcase> const& testcases)
+	{
+		std::vector<std::string> docs;
+		std::vector<docopt::GrammarSet> alone;
+		for(auto const& testcase : testcases) {
+			docs.push_back(testcase.doc);
+			alone.emplace_back(std::vector<std::string>{testcase.doc});
+		}
+
+		docopt::GrammarSet grammars(docs);
+
+		for(size_t own = 0; own < testcases.size(); ++own) {
+			for(auto const& argv : testcases[own].argvs) {
+				auto accepted = grammars.match(argv);
+
+				auto found = accepted.find(own);
+				try {
+					auto expected = docopt::docopt_parse(docs[own], argv, false, false);
+					if (found == accepted.end()) {
+						fail("grammar " + std::to_string(own) + " should accept " + show(argv));
+					} else if (found->second != expected) {
+						fail("grammar " + std::to_string(own) + " gave a different result for " + show(argv));
+					}
+				} catch (docopt::DocoptArgumentError const&) {
+					if (found != accepted.end())
+						fail("grammar " + std::to_string(own) + " should reject " + show(argv));
+				}
+
+				for(size_t i = 0; i < docs.size(); ++i) {
+					auto expected = alone[i].match(argv);
+					found = accepted.find(i);
+					if (expected.empty() != (found == accepted.end())
+					    || (found != accepted.end() && found->second != expected[0]))
+						fail("grammar " + std::to_string(i) + " differs from its own set for " + show(argv));
+				}
+			}
+		}
+	}
+
+	void check_value_kinds_are_distinct()
+	{
+		using namespace docopt;
+
+		if (value{}.hash() == value{std::vector<std::string>{}}.hash())
+			fail("an empty value and an empty list hash alike");
+		if (value{false}.hash() == value{0}.hash())
+			fail("'false' and '0' hash alike");
+
+		// pattern identity is based on the hash, so these must not be treated as the same pattern
+		if (Argument("<file>").hash() == Argument("<file>", value{std::vector<std::string>{}}).hash())
+			fail("an argument with no value and one with an empty list are the same pattern");
+		if (Option("-v", "", 0, value{false}).hash() == Option("-v", "", 0, value{0}).hash())
+			fail("an option with 'false' and one with '0' are the same pattern");
+	}
+
+	// Identical leaves with different defaults must not be shared between grammars
+	void check_leaves_not_merged()
+	{
+		docopt::GrammarSet grammars({
+			"Usage: p <file>...",
+			"Usage: p <file>",
+			"Usage: p [-v]...",
+			"Usage: p [-v]",
+		});
+
+		auto file = grammars.match({"a"});
+		if (file.size() != 2
+		    || file[0]["<file>"] != docopt::value{std::vector<std::string>{"a"}}
+		    || file[1]["<file>"] != docopt::value{std::string{"a"}})
+			fail("<file>... and <file> were merged");
+
+		auto once = grammars.match({"-v"});
+		if (once.size() != 2
+		    || once[2]["-v"] != docopt::value{1}
+		    || once[3]["-v"] != docopt::value{true})
+			fail("[-v]... and [-v] were merged");
+
+		auto twice = grammars.match({"-v", "-v"});
+		if (twice.size() != 1
+		    || twice[2]["-v"] != docopt::value{2})
+			fail("[-v]... did not count a repeated -v");
+	}
+
+	void check_moved_from()
+	{
+		docopt::GrammarSet grammars({"Usage: p"});
+		docopt::GrammarSet other = std::move(grammars);
+
+		if (other.size() != 1 || other.match({}).size() != 1)
+			fail("a moved-to set lost its grammars");
+		if (grammars.size() != 0 || !grammars.match({}).empty())
+			fail("a moved-from set is not empty");
+	}
+}
+
+int main(int argc, const char** argv)
+{
+	if (argc != 2) {
+		std::cerr << "Usage: run_grammarset TESTCASES" << std::endl;
+		exit(-5);
+	}
+
+	std::ifstream file(argv[1]);
+	if (!file) {
+		std::cerr << "Could not open " << argv[1] << std::endl;
+		exit(-5);
+	}
+	std::stringstream raw;
+	raw << file.rdbuf();
+
+	check_against_docopt_parse(parse_testcases(raw.str()));
+	check_value_kinds_are_distinct();
+	check_leaves_not_merged();
+	check_moved_from();
+
+	if (failures) {
+		std::cout << failures << " failures" << std::endl;
+		return 1;
+	}
+
+	std::cout << "PASS" << std::endl;
+	return 0;
+}